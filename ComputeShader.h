@@ -4,6 +4,11 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <map>
+#include <algorithm>
+
+// 编译期宏，插在 #version 之后，例如 {"INPUT_BITS", "8"}
+using ShaderDefines = std::map<std::string, std::string>;
 
 class ComputeShader {
 public:
@@ -20,6 +25,35 @@ public:
         source_ = buffer.str();
     }
 
+    ComputeShader(const std::string& filePath, const ShaderDefines& defines)
+        : ComputeShader(filePath) {
+        if (source_.empty() || defines.empty())
+            return;
+        std::string block;
+        for (const auto& [name, value] : defines)
+            block += "#define " + name + " " + value + "\n";
+        // 宏必须放在 #version 之后；它前面可能有注释、空行或 UTF-8 BOM
+        std::size_t pos = 0;
+        std::size_t lineStart = 0;
+        while (lineStart < source_.size()) {
+            std::size_t lineEnd = source_.find('\n', lineStart);
+            std::size_t first = source_.find_first_not_of(" \t\r\xEF\xBB\xBF", lineStart);
+            if (first != std::string::npos && first < std::min(lineEnd, source_.size())
+                && source_.compare(first, 8, "#version") == 0) {
+                if (lineEnd == std::string::npos) {
+                    source_ += '\n';
+                    lineEnd = source_.size() - 1;
+                }
+                pos = lineEnd + 1;
+                break;
+            }
+            if (lineEnd == std::string::npos)
+                break;
+            lineStart = lineEnd + 1;
+        }
+        source_.insert(pos, block);
+    }
+
     const std::string& Source() const { return source_; }
     const std::string& Path() const { return path_; }
 
@@ -11,6 +11,11 @@ GLBufferObject::GLBufferObject(GLenum target, const std::string& name, bool owns
 GLBufferObject::GLBufferObject(GLenum target, GLuint existingId, const std::string& name)
     : target_(target), id_(existingId), name_(name), ownsBuffer_(false) {
     initializeOpenGLFunctions();
+    if (id_) {
+        GLint64 size = 0;
+        glGetNamedBufferParameteri64v(id_, GL_BUFFER_SIZE, &size);
+        size_ = static_cast<std::size_t>(size);
+    }
 }
 
 GLBufferObject::~GLBufferObject() {
@@ -26,6 +31,7 @@ void GLBufferObject::Create(std::size_t size, const void* data, GLenum usage) {
         return;
     }
     glNamedBufferData(id_, size, data, usage);
+    size_ = size;
 }
 
 void GLBufferObject::UploadData(const void* data, std::size_t size, GLintptr offset) {
@@ -40,6 +46,7 @@ void GLBufferObject::Resize(std::size_t newSize, const void* data , GLenum usage
     }
     // 重新分配缓冲区空间，会丢弃之前数据
     glNamedBufferData(id_, newSize, data, usage);
+    size_ = newSize;
 }
 
 void GLBufferObject::BindToIndex(GLuint index) {
@@ -53,3 +60,7 @@ GLuint GLBufferObject::Id() const {
 const std::string& GLBufferObject::Name() const {
     return name_;
 }
+
+std::size_t GLBufferObject::GetSize() const {
+    return size_;
+}
@@ -17,10 +17,12 @@ public:
 
     GLuint Id() const;
     const std::string& Name() const;
+    std::size_t GetSize() const;
 
 protected:
     GLenum target_;
     GLuint id_ = 0;
+    std::size_t size_ = 0;
     std::string name_;
     bool ownsBuffer_ = true;
 };
@@ -1,27 +1,16 @@
 #include "ComputePipeline.h"
 
-ComputePipeline::ComputePipeline() {
+ComputePipeline::ComputePipeline(std::shared_ptr<ResourceRegistry> registry)
+    : registry_(std::move(registry)) {
     initializeOpenGLFunctions();
 }
 
-void ComputePipeline::AddShader(const std::string& name, std::shared_ptr<ComputeShader> shader) {
-    shaders_[name] = std::move(shader);
-}
-
-void ComputePipeline::AddSSBO(const std::string& name, std::shared_ptr<SSBO> ssbo) {
-    ssbos_[name] = std::move(ssbo);
-}
-
-void ComputePipeline::AddUBO(const std::string& name, std::shared_ptr<UBO> ubo) {
-    ubos_[name] = std::move(ubo);
-}
-bool ComputePipeline::UpdateSSBO(const std::string& name, size_t newSize, const void* data) {
-    auto it = ssbos_.find(name);
-    if (it == ssbos_.end()) {
-        std::cerr << "SSBO not found: " << name << std::endl;
+bool ComputePipeline::UpdateSSBO(SSBOHandle handle, size_t newSize, const void* data) {
+    SSBO* ssbo = registry_->ssbos.Get(handle);
+    if (!ssbo) {
+        std::cerr << "SSBO handle is invalid: " << handle.index << std::endl;
         return false;
     }
-    auto& ssbo = it->second;
     if(ssbo->GetSize() != newSize) {
         ssbo->Resize(newSize, data);
     } else {
@@ -29,21 +18,21 @@ bool ComputePipeline::UpdateSSBO(const std::string& name, size_t newSize, const
     }
     return true;
 }
-bool ComputePipeline::Build(const std::string& shaderName) {
-    auto existingIt = programs_.find(shaderName);
-    if (existingIt != programs_.end()) {
+bool ComputePipeline::Build(ShaderHandle shaderHandle) {
+    const std::string& shaderName = registry_->shaders.Name(shaderHandle);
+    if (GetProgram(shaderHandle)) {
         std::cout << "Program for shader [" << shaderName << "] already built, skipping rebuild." << std::endl;
         return true;
     }
 
-    auto it = shaders_.find(shaderName);
-    if (it == shaders_.end()) {
-        std::cerr << "Shader not found: " << shaderName << std::endl;
+    ComputeShader* shader = registry_->shaders.Get(shaderHandle);
+    if (!shader) {
+        std::cerr << "Shader handle is invalid: " << shaderHandle.index << std::endl;
         return false;
     }
 
     auto program = std::make_unique<QOpenGLShaderProgram>();
-    if (!program->addShaderFromSourceCode(QOpenGLShader::Compute, QString::fromStdString(it->second->Source()))) {
+    if (!program->addShaderFromSourceCode(QOpenGLShader::Compute, QString::fromStdString(shader->Source()))) {
         std::cerr << "Shader compile error: " << program->log().toStdString() << std::endl;
         return false;
     }
@@ -54,10 +43,10 @@ bool ComputePipeline::Build(const std::string& shaderName) {
 
     GLuint programId = program->programId();
 
-    for (const auto& [ssboName, ssboPtr] : ssbos_) {
+    registry_->ssbos.ForEach([&](SSBOHandle, const std::string& ssboName, SSBO& ssbo) {
         GLuint index = glGetProgramResourceIndex(programId, GL_SHADER_STORAGE_BLOCK, ssboName.c_str());
         if (index == GL_INVALID_INDEX) {
-            continue;
+            return;
         }
         GLenum props[] = { GL_BUFFER_BINDING };
         GLuint binding = 0;
@@ -65,12 +54,12 @@ bool ComputePipeline::Build(const std::string& shaderName) {
         glGetProgramResourceiv(programId, GL_SHADER_STORAGE_BLOCK, index, 1, props, 1, &length, reinterpret_cast<GLint*>(&binding));
 
         glShaderStorageBlockBinding(programId, index, binding);
-        ssboPtr->BindToIndex(binding);
-    }
+        ssbo.BindToIndex(binding);
+    });
 
-    for (const auto& [uboName, uboPtr] : ubos_) {
+    registry_->ubos.ForEach([&](UBOHandle, const std::string& uboName, UBO& ubo) {
         GLuint index = glGetProgramResourceIndex(programId, GL_UNIFORM_BLOCK, uboName.c_str());
-        if (index == GL_INVALID_INDEX) continue;
+        if (index == GL_INVALID_INDEX) return;
 
         GLenum props[] = { GL_BUFFER_BINDING };
         GLuint binding = 0;
@@ -78,46 +67,50 @@ bool ComputePipeline::Build(const std::string& shaderName) {
         glGetProgramResourceiv(programId, GL_UNIFORM_BLOCK, index, 1, props, 1, &length, reinterpret_cast<GLint*>(&binding));
 
         glUniformBlockBinding(programId, index, binding);
-        uboPtr->BindToIndex(binding);
-    }
+        ubo.BindToIndex(binding);
+    });
 
-    programs_[shaderName] = std::move(program);
+    if (programs_.size() <= shaderHandle.index)
+        programs_.resize(shaderHandle.index + 1);
+    programs_[shaderHandle.index].generation = shaderHandle.generation;
+    programs_[shaderHandle.index].program = std::move(program);
     return true;
 }
 
-void ComputePipeline::Dispatch(const std::string& shaderName, GLuint x, GLuint y, GLuint z) {
-    auto it = programs_.find(shaderName);
-    if (it == programs_.end()) {
-        std::cerr << "Program not built for shader: " << shaderName << std::endl;
-        return;
+bool ComputePipeline::Dispatch(ShaderHandle shader, GLuint x, GLuint y, GLuint z) {
+    QOpenGLShaderProgram* program = GetProgram(shader);
+    if (!program) {
+        std::cerr << "Program not built for shader handle: " << shader.index << std::endl;
+        return false;
     }
 
-    it->second->bind();
+    program->bind();
     glDispatchCompute(x, y, z);
     glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
-    it->second->release();
+    program->release();
+    return true;
 }
 
-template<typename Setter>
-bool ComputePipeline::SetUniformImpl(const std::string& shaderName, const std::string& uniformName, Setter setter) {
-    auto it = programs_.find(shaderName);
-    if (it == programs_.end()) {
-        std::cerr << "Program not found: " << shaderName << std::endl;
-        return false;
+GLint ComputePipeline::UniformLocation(ShaderHandle shader, const std::string& uniformName) {
+    QOpenGLShaderProgram* program = GetProgram(shader);
+    if (!program) {
+        std::cerr << "Program not built for shader handle: " << shader.index << std::endl;
+        return -1;
     }
-
-    QOpenGLShaderProgram* program = it->second.get();
-    program->bind();
     int loc = program->uniformLocation(QString::fromStdString(uniformName));
     if (loc < 0) {
         std::cerr << "Uniform not found: " << uniformName << std::endl;
-        program->release();
-        return false;
     }
+    return loc;
+}
 
-    setter(loc);
-    program->release();
-    return true;
+QOpenGLShaderProgram* ComputePipeline::GetProgram(ShaderHandle shader) const {
+    if (shader.index >= programs_.size() || !registry_->shaders.Contains(shader))
+        return nullptr;
+    const ProgramSlot& slot = programs_[shader.index];
+    if (slot.generation != shader.generation)
+        return nullptr;
+    return slot.program.get();
 }
 
 
@@ -11,42 +11,64 @@
 #include <QVector4D>
 #include <QMatrix4x4>
 #include <memory>
-#include <map>
+#include <vector>
 #include <string>
 #include <iostream>
 #include "ComputeShader.h"
 #include "ssbo.h"
+#include "resourceregistry.h"
 
 class ComputePipeline : protected QOpenGLFunctions_4_5_Core {
 public:
-    ComputePipeline();
+    explicit ComputePipeline(std::shared_ptr<ResourceRegistry> registry);
 
-    void AddShader(const std::string& name, std::shared_ptr<ComputeShader> shader);
-    void AddSSBO(const std::string& name, std::shared_ptr<SSBO> ssbo);
-    void AddUBO(const std::string& name, std::shared_ptr<UBO> ubo);
-    bool UpdateSSBO(const std::string& name, size_t newSize, const void* data);
-    bool Build(const std::string& shaderName);
+    bool UpdateSSBO(SSBOHandle handle, size_t newSize, const void* data);
+    bool Build(ShaderHandle shader);
 
-    void Dispatch(const std::string& shaderName, GLuint x, GLuint y = 1, GLuint z = 1);
+    bool Dispatch(ShaderHandle shader, GLuint x, GLuint y = 1, GLuint z = 1);
+    bool HasProgram(ShaderHandle shader) const { return GetProgram(shader) != nullptr; }
+
+    // 初始化阶段按名字查 uniform 位置，之后只用位置设置
+    GLint UniformLocation(ShaderHandle shader, const std::string& uniformName);
 
     template<typename T>
-    bool SetUniform(const std::string& shaderName, const std::string& uniformName, const T& value) {
-        return SetUniformImpl(shaderName, uniformName, [&](int location) {
-            programs_[shaderName]->setUniformValue(location, value);
+    bool SetUniform(ShaderHandle shader, GLint location, const T& value) {
+        return SetUniformImpl(shader, location, [&](QOpenGLShaderProgram* program) {
+            program->setUniformValue(location, value);
         });
     }
 
-    // Uniform setters
-    std::map<std::string, std::shared_ptr<SSBO>> GetSsbos(){return ssbos_;};
+    SSBO* GetSSBO(SSBOHandle handle) const { return registry_->ssbos.Get(handle); }
+    const std::shared_ptr<ResourceRegistry>& Registry() const { return registry_; }
 private:
+    QOpenGLShaderProgram* GetProgram(ShaderHandle shader) const;
+
     template<typename Setter>
-    bool SetUniformImpl(const std::string& shaderName, const std::string& uniformName, Setter setter);
+    bool SetUniformImpl(ShaderHandle shader, GLint location, Setter setter) {
+        QOpenGLShaderProgram* program = GetProgram(shader);
+        if (!program) {
+            std::cerr << "Program not built for shader handle: " << shader.index << std::endl;
+            return false;
+        }
+        if (location < 0) {
+            std::cerr << "Invalid uniform location for shader handle: " << shader.index << std::endl;
+            return false;
+        }
+        program->bind();
+        setter(program);
+        program->release();
+        return true;
+    }
 
 private:
-    std::map<std::string, std::shared_ptr<ComputeShader>> shaders_;
-    std::map<std::string, std::shared_ptr<SSBO>> ssbos_;
-    std::map<std::string, std::unique_ptr<QOpenGLShaderProgram>> programs_;
-    std::map<std::string, std::shared_ptr<UBO>> ubos_;
+    // 与 shader 池的槽位一一对应，generation 不一致说明槽位已被复用
+    struct ProgramSlot {
+        uint32_t generation = 0;
+        std::unique_ptr<QOpenGLShaderProgram> program;
+    };
+
+    std::shared_ptr<ResourceRegistry> registry_;
+    std::vector<ProgramSlot> programs_;
 };
 
 
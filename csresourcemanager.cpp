@@ -1,70 +1,84 @@
 #include "csResourceManager.h"
 
-void ResourceManager::LoadShaders(const std::map<std::string, std::string>& shaderFiles) {
+void ResourceManager::LoadShaders(const std::map<std::string, std::string>& shaderFiles, const ShaderDefines& defines) {
     for (const auto& [name, path] : shaderFiles) {
-        auto shader = std::make_shared<ComputeShader>(path);
-        shaders_[name] = shader;
+        if (registry_->shaders.Find(name).IsValid()) {
+            std::cerr << "Shader already exists: " << name << std::endl;
+            continue;
+        }
+        auto shader = std::make_shared<ComputeShader>(path, defines);
+        registry_->shaders.Add(name, shader);
         std::cout << "Loaded shader: " << name << " from " << path << std::endl;
     }
 }
 
 void ResourceManager::CreateSSBOs(const std::map<std::string, size_t>& ssboSizes, GLenum usage) {
     for (const auto& [name, size] : ssboSizes) {
+        if (registry_->ssbos.Find(name).IsValid()) {
+            std::cerr << "SSBO already exists: " << name << std::endl;
+            continue;
+        }
         auto ssbo = std::make_shared<SSBO>(name);
         ssbo->Create(size, nullptr,usage);
-        ssbos_[name] = ssbo;
+        registry_->ssbos.Add(name, ssbo);
         std::cout << "Created SSBO: " << name << " size: " << size << std::endl;
     }
 }
+
+SSBOHandle ResourceManager::CreatExternalSSBO(const std::string& name, GLuint existingBufferId) {
+    if (registry_->ssbos.Find(name).IsValid()) {
+        std::cerr << "SSBO already exists: " << name << std::endl;
+        return SSBOHandle{};
+    }
+    auto ssbo = std::make_shared<SSBO>(name, existingBufferId);
+    std::cout << "Registered external SSBO from GPU buffer id: " << existingBufferId << ", name: " << name << std::endl;
+    return registry_->ssbos.Add(name, ssbo);
+}
+
 // 批量注册外部已有的 SSBO
 void ResourceManager::AddExternalSSBOs(const std::map<std::string, GLuint>& externalSSBOs) {
     for (const auto& kv : externalSSBOs) {
-        const std::string& name = kv.first;
-        GLuint bufferId = kv.second;
-        auto ssbo = std::make_shared<SSBO>(name, bufferId);
-        ssbos_[name] = ssbo;
-        std::cout << "Registered external SSBO from GPU buffer id: " << bufferId << ", name: " << name << std::endl;
+        CreatExternalSSBO(kv.first, kv.second);
     }
 }
 
 void ResourceManager::CreateUBOs(const std::map<std::string, size_t>& uboSizes) {
     for (const auto& [name, size] : uboSizes) {
+        if (registry_->ubos.Find(name).IsValid()) {
+            std::cerr << "UBO already exists: " << name << std::endl;
+            continue;
+        }
         auto ubo = std::make_shared<UBO>(size);
-        ubos_[name] = ubo;
+        registry_->ubos.Add(name, ubo);
         std::cout << "Created UBO: " << name << " size: " << size << std::endl;
     }
 }
-std::shared_ptr<ComputeShader> ResourceManager::GetShader(const std::string& name) {
-    auto it = shaders_.find(name);
-    if (it == shaders_.end()) {
+
+ShaderHandle ResourceManager::FindShader(const std::string& name) const {
+    ShaderHandle handle = registry_->shaders.Find(name);
+    if (!handle.IsValid())
         std::cerr << "Shader not found: " << name << std::endl;
-        return nullptr;
-    }
-    return it->second;
+    return handle;
 }
 
-std::shared_ptr<SSBO> ResourceManager::GetSSBO(const std::string& name) {
-    auto it = ssbos_.find(name);
-    if (it == ssbos_.end()) {
+SSBOHandle ResourceManager::FindSSBO(const std::string& name) const {
+    SSBOHandle handle = registry_->ssbos.Find(name);
+    if (!handle.IsValid())
         std::cerr << "SSBO not found: " << name << std::endl;
-        return nullptr;
-    }
-    return it->second;
+    return handle;
 }
 
-std::shared_ptr<UBO> ResourceManager::GetUBO(const std::string& name) {
-    auto it = ubos_.find(name);
-    if (it == ubos_.end()) {
+UBOHandle ResourceManager::FindUBO(const std::string& name) const {
+    UBOHandle handle = registry_->ubos.Find(name);
+    if (!handle.IsValid())
         std::cerr << "UBO not found: " << name << std::endl;
-        return nullptr;
-    }
-    return it->second;
+    return handle;
 }
+
 void  ResourceManager::ReleaseAll()
 {
-    shaders_.clear();
-    ssbos_.clear();
-    ubos_.clear();
+    // ComputePipeline 可能还在使用同一个资源表，这里只释放自己的引用
+    registry_.reset();
 
 
 }
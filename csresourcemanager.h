@@ -6,66 +6,73 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <utility>
 #include "ComputeShader.h"
 #include "ssbo.h"
+#include "resourceregistry.h"
 
 class ResourceManager {
 public:
-    ResourceManager() = default;
+    ResourceManager() : registry_(std::make_shared<ResourceRegistry>()) {}
     // 禁止拷贝
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
 
-    // 允许移动
-    ResourceManager(ResourceManager&&) = default;
-    ResourceManager& operator=(ResourceManager&&) = default;
+    // 允许移动，被移走的对象换上一个空资源表，仍然可以继续使用
+    ResourceManager(ResourceManager&& other)
+        : registry_(std::exchange(other.registry_, std::make_shared<ResourceRegistry>())) {}
+    ResourceManager& operator=(ResourceManager&& other) {
+        if (this != &other)
+            registry_ = std::exchange(other.registry_, std::make_shared<ResourceRegistry>());
+        return *this;
+    }
 
     ~ResourceManager() {
         ReleaseAll();
     }
-    // 加载ComputeShader文件，传入名字和路径
-    void LoadShaders(const std::map<std::string, std::string>& shaderFiles);
+    // 加载ComputeShader文件，传入名字和路径，defines 会加到每个shader中
+    void LoadShaders(const std::map<std::string, std::string>& shaderFiles, const ShaderDefines& defines = {});
 
     // 创建SSBO，传入名字和大小（字节）
     void CreateSSBOs(const std::map<std::string, size_t>& ssboSizes, GLenum usage= GL_DYNAMIC_DRAW);
 
-    void CreatExternalSSBO(const std::string& name, GLuint existingBufferId) ;
+    SSBOHandle CreatExternalSSBO(const std::string& name, GLuint existingBufferId) ;
     // 创建UBO，传入名字和大小（字节）
     void CreateUBOs(const std::map<std::string, size_t>& uboSizes);
     void AddExternalSSBOs(const std::map<std::string, GLuint>& externalSSBOs);
     template<typename T>
-    void CreateSSBOWithData(const std::string& name, const std::vector<T>& data) {
+    SSBOHandle CreateSSBOWithData(const std::string& name, const std::vector<T>& data) {
+        if (registry_->ssbos.Find(name).IsValid()) {
+            std::cerr << "SSBO already exists: " << name << std::endl;
+            return SSBOHandle{};
+        }
         auto ssbo = std::make_shared<SSBO>(name);
         ssbo->Create(sizeof(T) * data.size(), data.data());
-        ssbos_[name] = ssbo;
         std::cout << "Created SSBO with data: " << name << " count: " << data.size() << std::endl;
+        return registry_->ssbos.Add(name, std::move(ssbo));
     }
 
     template<typename T>
-    bool UploadUBOData(const std::string& name, const std::vector<T>& data, GLintptr offset) {
-        auto it = ubos_.find(name);
-        if (it == ubos_.end()) {
-            std::cerr << "UBO not found: " << name << std::endl;
+    bool UploadUBOData(UBOHandle handle, const std::vector<T>& data, GLintptr offset) {
+        UBO* ubo = registry_->ubos.Get(handle);
+        if (!ubo) {
+            std::cerr << "UBO handle is invalid: " << handle.index << std::endl;
             return false;
         }
-        it->second->UploadData(data.data(), sizeof(T) * data.size(), offset);
+        ubo->UploadData(data.data(), sizeof(T) * data.size(), offset);
         return true;
     }
 
-    // 获取资源接口
-    std::shared_ptr<ComputeShader> GetShader(const std::string& name);
-    std::shared_ptr<SSBO> GetSSBO(const std::string& name);
-    std::shared_ptr<UBO> GetUBO(const std::string& name);
+    // 按名字查找句柄，只在初始化阶段使用
+    ShaderHandle FindShader(const std::string& name) const;
+    SSBOHandle FindSSBO(const std::string& name) const;
+    UBOHandle FindUBO(const std::string& name) const;
 
-    // 获取所有资源，方便遍历
-    const std::map<std::string, std::shared_ptr<ComputeShader>>& GetAllShaders() const { return shaders_; }
-    const std::map<std::string, std::shared_ptr<SSBO>>& GetAllSSBOs() const { return ssbos_; }
-    const std::map<std::string, std::shared_ptr<UBO>>& GetAllUBOs() const { return ubos_; }
+    // 共享资源表，交给ComputePipeline使用
+    const std::shared_ptr<ResourceRegistry>& Registry() const { return registry_; }
 
 private:
-    std::map<std::string, std::shared_ptr<ComputeShader>> shaders_;
-    std::map<std::string, std::shared_ptr<SSBO>> ssbos_;
-    std::map<std::string, std::shared_ptr<UBO>> ubos_;
+    std::shared_ptr<ResourceRegistry> registry_;
     void ReleaseAll();
 };
 
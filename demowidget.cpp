@@ -8,6 +8,8 @@
 #include <QString>
 #include <QDebug>
 #include "csresourcemanager.h"
+#include "gpuvalidator.h"
+#include "scanformat.h"
 // Run a function and measure its execution time in milliseconds
 template<typename Func>
 qint64 MeasureExecutionTime(Func&& func, const QString& info = QString())
@@ -91,31 +93,43 @@ void DemoWidget::PrepareBuffers(int dataSize,
 }
 
 bool DemoWidget::RunComputeShader(ComputePipeline& pipeline,
-                                  const std::string& shaderName,
+                                  ShaderHandle shader,
                                   int dispatchCount)
 {
-    if (!pipeline.Build(shaderName)) {
-        qWarning() << QString::fromStdString(shaderName) << "build failed";
+    if (!pipeline.Build(shader)) {
+        qWarning() << QString::fromStdString(pipeline.Registry()->shaders.Name(shader)) << "build failed";
         return false;
     }
-    pipeline.Dispatch(shaderName,dispatchCount);
+    if (!pipeline.Dispatch(shader,dispatchCount))
+        return false;
     glFinish(); // Wait for GPU to complete
     return true;
 }
 
-void DemoWidget::ReadBuffer(std::shared_ptr<SSBO> ssbo, int elementCount, std::vector<uint32_t>& output)
+void DemoWidget::ReadBuffer(const SSBO* ssbo, int elementCount, std::size_t elementSize, std::vector<uint64_t>& output)
 {
+    if (!ssbo) {
+        qWarning() << "ReadBuffer: invalid SSBO";
+        return;
+    }
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo->Id());
-    void* ptr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(uint32_t) * elementCount, GL_MAP_READ_BIT);
+    void* ptr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, elementSize * elementCount, GL_MAP_READ_BIT);
     output.resize(elementCount);
     if (ptr) {
-        memcpy(output.data(), ptr, sizeof(uint32_t) * elementCount);
+        // 按输出位宽读取，统一扩展成 64 位
+        if (elementSize == sizeof(uint64_t)) {
+            memcpy(output.data(), ptr, sizeof(uint64_t) * elementCount);
+        } else {
+            const uint32_t* words = static_cast<const uint32_t*>(ptr);
+            for (int i = 0; i < elementCount; ++i)
+                output[i] = words[i];
+        }
         glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
     }
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
-void DemoWidget::VerifyOutput(const std::vector<uint32_t>& output, int printCount = 16)
+void DemoWidget::VerifyOutput(const std::vector<uint64_t>& output, int printCount = 16)
 {
     QString s;
     for (int i = 0; i < printCount && i < (int)output.size(); ++i)
@@ -123,61 +137,111 @@ void DemoWidget::VerifyOutput(const std::vector<uint32_t>& output, int printCoun
     qDebug() << "Output first" << printCount << "values:" << s;
 }
 
+void DemoWidget::ReportValidation(const ValidationReport& report)
+{
+    if (!report.ran) {
+        qWarning() << "GPU validation did not run";
+        return;
+    }
+    if (report.Passed()) {
+        qDebug() << "GPU validation passed";
+        return;
+    }
+    QString s;
+    for (uint32_t index : report.failIndices)
+        s += QString::number(index) + " ";
+    qWarning() << "GPU validation failed:" << report.mismatchCount << "mismatches, first at"
+               << report.firstFailure << "first failing indices:" << s;
+    if (!report.ChecksumMatches())
+        qWarning() << "Checksum mismatch: output" << report.checksum << "input" << report.inputChecksum;
+}
+
 void DemoWidget::RunDemoPipeline()
 {
     const int dataSize = 10000000; // Test with 100,000 elements
+    const bool validateOnGpu = true; // GPU校验时只回读前几个值用于打印
+    // 8位输入，32位输出；回读按 OutputElementSize 处理，64位输出同样适用
+    const ScanFormat format{ InputFormat::UInt8, OutputFormat::UInt32 };
     ResourceManager rm;
 
     // 加载shader
     rm.LoadShaders({
                     {"BlockScan", "C:/Users/xzr/Documents/Demo/shaders/blockScan.comp"},
+                    {"ScanBlockSums", "C:/Users/xzr/Documents/Demo/shaders/scanBlockSums.comp"},
                     {"AddBlockSums", "C:/Users/xzr/Documents/Demo/shaders/addBlockSums.comp"},
-                    });
-
-    // 创建并初始化SSBO
-    std::vector<uint32_t> inputData = GenerateRandomData(dataSize, 1, dataSize);
-    rm.CreateSSBOWithData("InputBuffer", inputData);
+                    }, format.Defines());
+
+    // 创建并初始化SSBO，输入按位宽打包后上传
+    std::vector<uint32_t> inputData = GenerateRandomData(dataSize, 1, format.MaxInputValue());
+    std::vector<uint32_t> packedInput;
+    if (!PackInput(inputData, format.input, packedInput)) {
+        qWarning() << "Input data does not fit the selected input format";
+        return;
+    }
+    rm.CreateSSBOWithData("InputBuffer", packedInput);
 
     // 创建空SSBO和UBO
     rm.CreateSSBOs({
-        {"OutputBuffer", dataSize * sizeof(uint32_t)},
-        {"BlockSums", ((dataSize + 255) / 256) * sizeof(uint32_t)}
+        {"OutputBuffer", dataSize * format.OutputElementSize()},
+        {"BlockSums", ((dataSize + 255) / 256) * format.OutputElementSize()}
     });
 
+    GpuValidator validator(rm, "C:/Users/xzr/Documents/Demo/shaders/validateOutput.comp", format.Defines());
 
-    // 加载所有资源到ComputePipeline
-    ComputePipeline pipeline;
-    for (auto& [name, shader] : rm.GetAllShaders())
-        pipeline.AddShader(name, shader);
-    for (auto& [name, ssbo] : rm.GetAllSSBOs())
-        pipeline.AddSSBO(name, ssbo);
-    for (auto& [name, ubo] : rm.GetAllUBOs())
-        pipeline.AddUBO(name, ubo); // 你需要在ComputePipeline中加这个接口
+    // 名字只在这里解析成句柄，之后的调度都走句柄
+    ShaderHandle blockScan = rm.FindShader("BlockScan");
+    ShaderHandle scanBlockSums = rm.FindShader("ScanBlockSums");
+    ShaderHandle addBlockSums = rm.FindShader("AddBlockSums");
+    SSBOHandle outputBuffer = rm.FindSSBO("OutputBuffer");
+
+    // ComputePipeline 与 ResourceManager 共享同一个资源表
+    ComputePipeline pipeline(rm.Registry());
 
     int numBlocks = (dataSize + 256 - 1) / 256;
 
     // Run the first shader and measure execution time
     qint64 tBlockScan = MeasureExecutionTime([&]() {
-        RunComputeShader(pipeline, "BlockScan", numBlocks);
+        RunComputeShader(pipeline, blockScan, numBlocks);
     }, "BlockScan shader execution");
 
-    // Run the second shader and measure execution time
+    // Turn per-block totals into running totals across blocks (single workgroup)
+    qint64 tScanBlockSums = MeasureExecutionTime([&]() {
+        RunComputeShader(pipeline, scanBlockSums, 1);
+    }, "ScanBlockSums shader execution");
+
+    // Run the third shader and measure execution time
     qint64 tAddBlockSums = MeasureExecutionTime([&]() {
-        RunComputeShader(pipeline, "AddBlockSums", numBlocks);
+        RunComputeShader(pipeline, addBlockSums, numBlocks);
     }, "AddBlockSums shader execution");
 
-    // Read output buffer and measure time (can be skipped for pure GPU timing)
-    std::vector<uint32_t> outputData;
+    // Check scan invariants on the GPU, only the small result buffer is read back
+    qint64 tValidate = 0;
+    if (validateOnGpu) {
+        ValidationReport report;
+        bool validated = false;
+        tValidate = MeasureExecutionTime([&]() {
+            validated = validator.Validate(pipeline, ValidationMode::ExclusiveScan, dataSize, report);
+        }, "GPU validation");
+        if (validated)
+            ReportValidation(report);
+        else
+            qWarning() << "GPU validation did not run";
+    }
 
+    // Read output buffer and measure time (can be skipped for pure GPU timing)
+    std::vector<uint64_t> outputData;
+    const int readCount = validateOnGpu ? 16 : dataSize;
 
     qint64 tReadOutput = MeasureExecutionTime([&]() {
-        ReadBuffer(pipeline.GetSsbos()["OutputBuffer"], dataSize, outputData);
+        ReadBuffer(pipeline.GetSSBO(outputBuffer), readCount, format.OutputElementSize(), outputData);
     }, "Reading output buffer");
 
     VerifyOutput(outputData, 16);
 
     qDebug() << "=== Timing summary (ms) ===";
     qDebug() << "BlockScan:" << tBlockScan;
+    qDebug() << "ScanBlockSums:" << tScanBlockSums;
     qDebug() << "AddBlockSums:" << tAddBlockSums;
+    qDebug() << "Validate:" << tValidate;
     qDebug() << "ReadOutput:" << tReadOutput;
 }
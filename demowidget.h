@@ -5,6 +5,7 @@
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions_4_5_Core>
 #include "computepipeline.h"
+#include "gpuvalidator.h"
 
 class DemoWidget : public QOpenGLWidget, protected QOpenGLFunctions_4_5_Core
 {
@@ -22,10 +23,11 @@ void PrepareBuffers(int dataSize,
 private:
     void RunDemoPipeline();
      bool RunComputeShader(ComputePipeline& pipeline,
-                                 const std::string& shaderName,
+                                 ShaderHandle shader,
                           int dispatchCount);
-    void ReadBuffer(std::shared_ptr<SSBO> ssbo, int elementCount, std::vector<uint32_t>& output);
-    void VerifyOutput(const std::vector<uint32_t>& output, int printCount);
+    void ReadBuffer(const SSBO* ssbo, int elementCount, std::size_t elementSize, std::vector<uint64_t>& output);
+    void VerifyOutput(const std::vector<uint64_t>& output, int printCount);
+    void ReportValidation(const ValidationReport& report);
 };
 
 
@@ -0,0 +1,68 @@
+#include "gpuvalidator.h"
+#include <algorithm>
+#include <iterator>
+
+GpuValidator::GpuValidator(ResourceManager& rm, const std::string& shaderPath, const ShaderDefines& defines) {
+    initializeOpenGLFunctions();
+    // 名字带上宏，不同位宽的校验器各自注册一个 shader；相同配置则复用
+    std::string shaderName = "ValidateOutput";
+    for (const auto& [name, value] : defines)
+        shaderName += ":" + name + "=" + value;
+
+    const auto& registry = rm.Registry();
+    if (!registry->shaders.Find(shaderName).IsValid())
+        rm.LoadShaders({ {shaderName, shaderPath} }, defines);
+    // 结果缓冲区名字必须与着色器中的块名一致，多个校验器共用，每次 Validate 前重置
+    if (!registry->ssbos.Find("ValidationResult").IsValid())
+        rm.CreateSSBOs({ {"ValidationResult", sizeof(ValidationResultData)} });
+    shader_ = rm.FindShader(shaderName);
+    result_ = rm.FindSSBO("ValidationResult");
+}
+
+bool GpuValidator::Validate(ComputePipeline& pipeline, ValidationMode mode, uint32_t elementCount, ValidationReport& report) {
+    report = ValidationReport{};
+    // program 属于具体的 pipeline，每次都向传入的 pipeline 确认
+    if (!pipeline.HasProgram(shader_) && !pipeline.Build(shader_)) {
+        std::cerr << "Validation shader build failed" << std::endl;
+        return false;
+    }
+    GLint modeLocation = pipeline.UniformLocation(shader_, "mode");
+    GLint countLocation = pipeline.UniformLocation(shader_, "elementCount");
+
+    SSBO* result = pipeline.GetSSBO(result_);
+    if (!result) {
+        std::cerr << "Validation result buffer is invalid" << std::endl;
+        return false;
+    }
+
+    ValidationResultData data{};
+    std::fill(std::begin(data.failIndices), std::end(data.failIndices), 0xFFFFFFFFu);
+    result->UploadData(&data, sizeof(data));
+
+    if (!pipeline.SetUniform(shader_, modeLocation, static_cast<GLuint>(mode))
+        || !pipeline.SetUniform(shader_, countLocation, static_cast<GLuint>(elementCount))) {
+        std::cerr << "Validation uniforms could not be set" << std::endl;
+        return false;
+    }
+    if (!pipeline.Dispatch(shader_, (elementCount + 255) / 256)) {
+        std::cerr << "Validation dispatch failed" << std::endl;
+        return false;
+    }
+
+    // Dispatch 里的屏障只覆盖着色器访问，回读前还需要 BUFFER_UPDATE
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetNamedBufferSubData(result->Id(), 0, sizeof(data), &data);
+
+    // 所有步骤都成功后才认为校验已执行
+    report.ran = true;
+    report.mismatchCount = data.mismatchCount;
+    report.checksumChecked = (mode == ValidationMode::SortedAscending);
+    report.checksum = data.checksum;
+    report.inputChecksum = data.inputChecksum;
+    // 着色器已按升序保留最小的下标
+    uint32_t recorded = std::min<uint32_t>(data.mismatchCount, kMaxRecordedFailures);
+    report.failIndices.assign(data.failIndices, data.failIndices + recorded);
+    if (recorded > 0)
+        report.firstFailure = report.failIndices.front();
+    return true;
+}
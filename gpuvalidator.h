@@ -0,0 +1,54 @@
+#ifndef GPUVALIDATOR_H
+#define GPUVALIDATOR_H
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "computepipeline.h"
+#include "csresourcemanager.h"
+
+// 与 validateOutput.comp 中的 mode 对应
+enum class ValidationMode : GLuint {
+    ExclusiveScan = 0,   // out[0] == 0, out[i] - out[i-1] == in[i-1]
+    InclusiveScan = 1,   // out[i] - out[i-1] == in[i]
+    SortedAscending = 2, // out[i-1] <= out[i]，且输入输出校验和相同
+};
+
+struct ValidationReport {
+    bool ran = false;    // 校验着色器确实执行并回读了结果
+    uint32_t mismatchCount = 0;
+    uint32_t firstFailure = 0xFFFFFFFFu;   // 等于 failIndices[0]
+    bool checksumChecked = false;
+    uint32_t checksum = 0;       // 输出元素之和（mod 2^32）
+    uint32_t inputChecksum = 0;  // 输入元素之和（mod 2^32）
+    std::vector<uint32_t> failIndices;     // 最小的若干个失败下标，升序
+
+    bool ChecksumMatches() const { return !checksumChecked || checksum == inputChecksum; }
+    bool Passed() const { return ran && mismatchCount == 0 && ChecksumMatches(); }
+};
+
+// 在GPU上检查 InputBuffer/OutputBuffer 的结果，只回读几十字节的统计信息
+class GpuValidator : protected QOpenGLFunctions_4_5_Core {
+public:
+    static constexpr int kMaxRecordedFailures = 8;
+
+    // defines 需要与被检查的扫描着色器一致（输入/输出位宽）
+    GpuValidator(ResourceManager& rm, const std::string& shaderPath, const ShaderDefines& defines = {});
+
+    bool Validate(ComputePipeline& pipeline, ValidationMode mode, uint32_t elementCount, ValidationReport& report);
+
+private:
+    // std430 布局，与着色器中的 ValidationResult 块一致
+    struct ValidationResultData {
+        uint32_t mismatchCount;
+        uint32_t checksum;
+        uint32_t inputChecksum;
+        uint32_t failIndices[kMaxRecordedFailures];
+    };
+
+    ShaderHandle shader_;
+    SSBOHandle result_;
+};
+
+#endif // GPUVALIDATOR_H
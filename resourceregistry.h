@@ -0,0 +1,130 @@
+#ifndef RESOURCEREGISTRY_H
+#define RESOURCEREGISTRY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ComputeShader.h"
+#include "SSBO.h"
+
+// 资源句柄：index 指向池中的槽位，generation 用来识别槽位被回收后的过期句柄
+template<typename Tag>
+struct ResourceHandle {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != kInvalidIndex; }
+
+    friend bool operator==(const ResourceHandle& a, const ResourceHandle& b) {
+        return a.index == b.index && a.generation == b.generation;
+    }
+    friend bool operator!=(const ResourceHandle& a, const ResourceHandle& b) {
+        return !(a == b);
+    }
+};
+
+struct ShaderTag {};
+struct SSBOTag {};
+struct UBOTag {};
+
+using ShaderHandle = ResourceHandle<ShaderTag>;
+using SSBOHandle = ResourceHandle<SSBOTag>;
+using UBOHandle = ResourceHandle<UBOTag>;
+
+// 连续存储的资源池，名字只在注册和查找时使用，Get 走下标访问
+template<typename T, typename Tag>
+class ResourcePool {
+public:
+    using Handle = ResourceHandle<Tag>;
+
+    // 名字已存在时拒绝注册并返回无效句柄：原地替换会让已编译的 program 和绑定点指向旧资源
+    Handle Add(const std::string& name, std::shared_ptr<T> resource) {
+        if (lookup_.count(name))
+            return Handle{};
+
+        uint32_t index;
+        if (!freeList_.empty()) {
+            index = freeList_.back();
+            freeList_.pop_back();
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot& slot = slots_[index];
+        slot.resource = std::move(resource);
+        slot.name = name;
+
+        Handle handle{ index, slot.generation };
+        lookup_[name] = handle;
+        return handle;
+    }
+
+    bool Remove(Handle handle) {
+        if (!Contains(handle))
+            return false;
+        Slot& slot = slots_[handle.index];
+        lookup_.erase(slot.name);
+        slot.resource.reset();
+        slot.name.clear();
+        ++slot.generation;
+        freeList_.push_back(handle.index);
+        return true;
+    }
+
+    bool Contains(Handle handle) const {
+        return handle.index < slots_.size()
+            && slots_[handle.index].generation == handle.generation
+            && slots_[handle.index].resource;
+    }
+
+    // 热路径：不做字符串查找，也不复制 shared_ptr
+    T* Get(Handle handle) const {
+        return Contains(handle) ? slots_[handle.index].resource.get() : nullptr;
+    }
+
+    Handle Find(const std::string& name) const {
+        auto it = lookup_.find(name);
+        return it == lookup_.end() ? Handle{} : it->second;
+    }
+
+    const std::string& Name(Handle handle) const {
+        static const std::string empty;
+        return Contains(handle) ? slots_[handle.index].name : empty;
+    }
+
+    // 遍历所有存活的资源，func(handle, name, resource)
+    template<typename Func>
+    void ForEach(Func&& func) const {
+        for (uint32_t i = 0; i < slots_.size(); ++i) {
+            const Slot& slot = slots_[i];
+            if (slot.resource)
+                func(Handle{ i, slot.generation }, slot.name, *slot.resource);
+        }
+    }
+
+private:
+    struct Slot {
+        std::shared_ptr<T> resource;
+        std::string name;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeList_;
+    std::unordered_map<std::string, Handle> lookup_;
+};
+
+// ResourceManager 和 ComputePipeline 共享的资源表
+class ResourceRegistry {
+public:
+    ResourcePool<ComputeShader, ShaderTag> shaders;
+    ResourcePool<SSBO, SSBOTag> ssbos;
+    ResourcePool<UBO, UBOTag> ubos;
+};
+
+#endif // RESOURCEREGISTRY_H
@@ -0,0 +1,69 @@
+#ifndef SCANFORMAT_H
+#define SCANFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ComputeShader.h"
+
+// 输入元素位宽，窄类型在 GPU 上按 uvec4 读入后解包
+enum class InputFormat {
+    Bits1 = 1,
+    UInt8 = 8,
+    UInt16 = 16,
+    UInt32 = 32,
+};
+
+// 输出（前缀和）位宽，64 位需要 GL_ARB_gpu_shader_int64
+enum class OutputFormat {
+    UInt32 = 32,
+    UInt64 = 64,
+};
+
+struct ScanFormat {
+    InputFormat input = InputFormat::UInt32;
+    OutputFormat output = OutputFormat::UInt32;
+
+    // blockScan / addBlockSums / validateOutput 共用的宏
+    ShaderDefines Defines() const {
+        return {
+            {"INPUT_BITS", std::to_string(static_cast<int>(input))},
+            {"OUTPUT_BITS", std::to_string(static_cast<int>(output))},
+        };
+    }
+
+    std::size_t OutputElementSize() const {
+        return output == OutputFormat::UInt64 ? sizeof(uint64_t) : sizeof(uint32_t);
+    }
+
+    uint32_t MaxInputValue() const {
+        return input == InputFormat::UInt32 ? 0xFFFFFFFFu : (1u << static_cast<int>(input)) - 1u;
+    }
+};
+
+// 把输入按位宽小端打包成 32 位字，并补齐到 16 字节，保证着色器的 uvec4 读取不越界
+// 有值超出位宽时返回 false，不做截断
+template<typename T>
+bool PackInput(const std::vector<T>& values, InputFormat format, std::vector<uint32_t>& words) {
+    const int bits = static_cast<int>(format);
+    const std::size_t perWord = 32 / bits;
+    const std::size_t wordCount = (values.size() + perWord - 1) / perWord;
+    const uint64_t mask = (uint64_t(1) << bits) - 1u;
+
+    words.assign((wordCount + 3) / 4 * 4, 0u);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        uint64_t value = static_cast<uint64_t>(values[i]);
+        if (value > mask) {
+            std::cerr << "PackInput: value " << value << " at index " << i
+                      << " does not fit in " << bits << " bits" << std::endl;
+            words.clear();
+            return false;
+        }
+        words[i / perWord] |= static_cast<uint32_t>(value) << ((i % perWord) * bits);
+    }
+    return true;
+}
+
+#endif // SCANFORMAT_H